@@ -0,0 +1,50 @@
+/**
+ *  This file is part of CLOrca.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * C++20 module interface of the compiled clorca library. Usage: "import clorca;"
+ * CLOrca.h is included in the global module fragment, so the declarations
+ * stay attached to the global module and are defined by CLOrca.cpp.
+ */
+
+module;
+
+#ifndef CLORCA_COMPILED
+    #define CLORCA_COMPILED
+#endif
+
+#include"CLOrca.h"
+
+export module clorca;
+
+export namespace CLOrca {
+    using ::CLOrca::unlimited_arguments;
+    using ::CLOrca::Config;
+    using ::CLOrca::OptionInfo;
+    using ::CLOrca::Error;
+    using ::CLOrca::Handle;
+    using ::CLOrca::Delimiter;
+    using ::CLOrca::PathStatus;
+    using ::CLOrca::PathCheck;
+    using ::CLOrca::Span;
+    using ::CLOrca::Elements;
+    using ::CLOrca::Option;
+    using ::CLOrca::CLOrca;
+#if CLORCA_DIAGNOSTICS == CLORCA_DIAGNOSTICS_CALLBACK
+    using ::CLOrca::diagnostic;
+#endif
+};
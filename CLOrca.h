@@ -19,15 +19,42 @@
 
 #pragma once
 
-#include<iostream>
 #include<vector>
-#include<cstring>
-#include<algorithm>
-#include<filesystem>
+#include<string>
+#include<string_view>
+#include<cstddef>
+#include<initializer_list>
 #include"Option.h"
 
+/**
+ * Where CLOrca prints its error messages. Chosen at compile time, so the
+ * sinks that aren't used don't get compiled in:
+ *  CLORCA_DIAGNOSTICS_IOSTREAM - std::cerr (default)
+ *  CLORCA_DIAGNOSTICS_FD       - a single write() to stderr, no <iostream> needed
+ *  CLORCA_DIAGNOSTICS_CALLBACK - CLOrca::diagnostic(), which has to be defined by user
+ *  CLORCA_DIAGNOSTICS_NONE     - nowhere
+ */
+#define CLORCA_DIAGNOSTICS_NONE 0
+#define CLORCA_DIAGNOSTICS_IOSTREAM 1
+#define CLORCA_DIAGNOSTICS_FD 2
+#define CLORCA_DIAGNOSTICS_CALLBACK 3
+
+#ifndef CLORCA_DIAGNOSTICS
+    #define CLORCA_DIAGNOSTICS CLORCA_DIAGNOSTICS_IOSTREAM
+#endif
+
 namespace CLOrca {
-    constexpr int unlimited_arguments{-1};
+    inline constexpr int unlimited_arguments{-1};
+
+#if CLORCA_DIAGNOSTICS == CLORCA_DIAGNOSTICS_CALLBACK
+    /**
+     * Receive an error message. Defined by user when CLORCA_DIAGNOSTICS is
+     * set to CLORCA_DIAGNOSTICS_CALLBACK
+     *
+     * @param message Message with Config::error_prefix and without a trailing newline
+     */
+    void diagnostic(std::string_view message);
+#endif
 
     /**
      * Other configurational variables
@@ -36,6 +63,13 @@ namespace CLOrca {
         std::string_view error_prefix{"CLOrca error: "};
         bool verbose{true};
         int arguments_limit{unlimited_arguments};
+        /** @var Requirements for arguments that are paths. @see PathCheck */
+        PathCheck argument_paths{};
+        /**
+         * @var Threads used to check paths. 0 means std::thread::hardware_concurrency().
+         * Ignored unless CLOrca is built with CLORCA_THREADS
+         */
+        unsigned path_check_threads{};
     };
 
     /**
@@ -60,6 +94,34 @@ namespace CLOrca {
         NotPossibleOption,
         OptionDoesntExist,
         TooMuchArguments,
+        InvalidPath,
+    };
+
+    /**
+     * Option resolved once by CLOrca::handle(). Querying an option through
+     * a handle takes constant time and doesn't allocate anything.
+     * A handle belongs to the CLOrca object that created it. Passing it to
+     * another object is safe, but may refer to a different option there.
+     */
+    class Handle {
+        friend class CLOrca;
+        static constexpr std::size_t invalid{static_cast<std::size_t>(-1)};
+        std::size_t index{invalid};
+
+        explicit Handle(const std::size_t index): index(index)
+        {
+        }
+
+    public:
+        Handle() = default;
+
+        /**
+         * Whether a handle refers to an existing option
+         */
+        explicit operator bool() const
+        {
+            return index != invalid;
+        }
     };
 
     class CLOrca {
@@ -72,15 +134,25 @@ namespace CLOrca {
         const Config config;
         int error{};
 
+        /** @var Results of path checks for arguments. @see Config::argument_paths */
+        std::vector<PathStatus> argument_statuses;
+
         /**
-         * Print error
+         * Print error. Parts of the message are only joined if it's actually
+         * going to be printed.
          *
-         * @param message Message to print
+         * @param message Parts of the message to print
+         * @see CLORCA_DIAGNOSTICS
          */
-        void print_error(const std::string& message) const
+        void print_error(std::initializer_list<std::string_view> message) const;
+
+        /**
+         * Whether error messages are printed at all. Call sites that have to
+         * build strings for a message check it first.
+         */
+        bool reporting() const
         {
-            if (config.verbose)
-                std::cerr << config.error_prefix << message << "\n";
+            return CLORCA_DIAGNOSTICS != CLORCA_DIAGNOSTICS_NONE && config.verbose;
         }
 
         /**
@@ -89,25 +161,7 @@ namespace CLOrca {
          *
          * @param option
          */
-        OptionInfo get_option_info(const std::string& option)
-        {
-            std::string fetched_option, fetched_value;
-            bool separator_switch{};
-
-            for (const unsigned char a : option) {
-                if (a == SEPARATOR && !separator_switch) {
-                    separator_switch = true;
-                    continue;
-                }
-
-                if (separator_switch)
-                    fetched_value += a;
-                else
-                    fetched_option += a;
-            }
-
-            return {fetched_option, fetched_value, separator_switch};
-        }
+        OptionInfo get_option_info(const std::string& option);
 
         /**
          * If an option is in short format, then will split all options
@@ -116,64 +170,14 @@ namespace CLOrca {
          *
          * @param option
          */
-        void load_simple_options(const std::string& option)
-        {
-            for (int i{}; i < option.size(); ++i) {
-                // Skipping "-"
-                if (!i)
-                    continue;
-
-                if (option.size() > i + 1 && option.at(i + 1) == SEPARATOR) {
-                    load_option("-" + option.substr(i));
-                    break;
-                }
-                else
-                    load_option("-" + std::string(1, option.at(i)));
-            }
-        }
+        void load_simple_options(const std::string& option);
 
         /**
          * Process one option
          *
          * @param option
          */
-        void load_option(const std::string& raw_option)
-        {
-            OptionInfo info{get_option_info(raw_option)};
-            Option* cli_option{find_option(info.option)};
-
-            if (!cli_option) {
-                error = Error::NotPossibleOption;
-                return;
-            }
-
-            cli_option->provided = true;
-
-            if (waiting_value_option) {
-                error = Error::MissingValue;
-                print_error("Got another option while previous option \""
-                      + waiting_value_option->aliases.at(0) + "\" is waiting for a value");
-                waiting_value_option = nullptr;
-            }
-
-            if (cli_option->is_compound()) {
-                if (info.has_separator) {
-                    if (info.value.size())
-                        cli_option->values.push_back(info.value);
-                    else {
-                        error = Error::MissingValue;
-                        print_error("Expecting a value for the option \"" + info.option
-                              + "\" after \"" + std::string(1, SEPARATOR) + "\"");
-                    }
-                } else
-                    waiting_value_option = cli_option;
-            }
-            else if (info.has_separator) {
-                error = Error::OptionCantHoldValue;
-                print_error("Option \"" + info.option
-                            + "\" is not compound and can't hold a value");
-            }
-        }
+        void load_option(const std::string& raw_option);
 
         /**
          * Process and load options and arguments
@@ -182,58 +186,49 @@ namespace CLOrca {
          * @param argv
          * @return Whether the loading was successful. False if any errors occurred
          */
-        bool load_options(const int argc, const char** argv)
+        bool load_options(const int argc, const char** argv);
+
+        /**
+         * Get an option a handle refers to
+         *
+         * @param h Option handle
+         * @return nullptr if handle is invalid or doesn't belong to this object
+         */
+        const Option* resolve(const Handle h) const
         {
-            for (int i{}; i < argc; ++i) {
-                const std::string curr_arg{argv[i]};
-
-                if (i == 0) {
-                    executable_name = std::filesystem::path(curr_arg).filename().string();
-                    continue;
-                }
-
-                // If current argument is an option
-                if (curr_arg.at(0) == '-') {
-                    if (curr_arg.size() > 1 && curr_arg.at(1) == '-')
-                        load_option(curr_arg);
-                    else
-                        load_simple_options(curr_arg);
-                }
-                // If current argument is not an option, then will check
-                // if any option is waiting for a value
-                else if (waiting_value_option) {
-                    waiting_value_option->values.push_back(curr_arg);
-                    waiting_value_option = nullptr;
-                }
-                // If no option is waiting for a value, then just append
-                // current argument to arguments
-                else
-                    arguments.push_back(curr_arg);
-            }
-
-            if (waiting_value_option) {
-                error = Error::MissingValue;
-                print_error("Missing value for option \""
-                            + waiting_value_option->aliases.at(0) + "\"");
-            }
-
-            if (
-                config.arguments_limit != ::CLOrca::unlimited_arguments
-                && arguments.size() > config.arguments_limit
-            ) {
-                error = Error::TooMuchArguments;
-                print_error("Unexpected amount of arguments: "
-                            + std::to_string(arguments.size())
-                            + ". Maximum expected amount is: "
-                            + std::to_string(config.arguments_limit)
-                );
-            }
+            if (!h || h.index >= options.size())
+                return nullptr;
 
-            return error;
+            return &options[h.index];
         }
 
+        /**
+         * Check one path
+         *
+         * @param buffer Reused to make a null-terminated copy of the path
+         * @param path
+         * @param check Requirements
+         */
+        static PathStatus check_path(std::string& buffer, const std::string_view path, const PathCheck& check);
+
+        /**
+         * Check paths of all options and arguments that have a PathCheck.
+         * With CLORCA_THREADS paths are split in batches that are checked by
+         * several threads at once. If there are too few paths or a thread can't
+         * be started, the rest of the paths is checked in the current thread.
+         * Without it all the paths are checked in the current thread.
+         *
+         * @see Config::path_check_threads
+         */
+        void validate_paths();
+
     public:
         static constexpr unsigned char SEPARATOR{'='};
+    #ifdef _WIN32
+        static constexpr std::string_view PATH_SEPARATORS{"/\\"};
+    #else
+        static constexpr std::string_view PATH_SEPARATORS{"/"};
+    #endif
         std::string executable_name;
 
         /**
@@ -250,10 +245,7 @@ namespace CLOrca {
             const std::vector<Option>& options,
             const std::vector<std::string> default_arguments = {},
             const Config& config = CLOrca::default_config
-        ): options(options), config(config), default_arguments(default_arguments)
-        {
-            load_options(argc, argv);
-        }
+        );
 
         /**
          * Find option by its alias
@@ -264,39 +256,73 @@ namespace CLOrca {
          *                will be displayed anyways.
          * @return Pointer to an option or nullptr if option wasn't found
          */
-        Option* find_option(const std::string& option, const bool verbose = true)
-        {
-            auto f{std::find_if(options.begin(), options.end(), [option] (Option& o) {
-                return o.has_alias(option);
-            })};
-
-            if (f != options.end())
-                return &(*f);
+        Option* find_option(const std::string_view option, const bool verbose = true);
 
-            if (verbose)
-                print_error("Option \"" + option + "\" isn't a possible option");
+        /**
+         * Resolve an option once to query it later without a lookup
+         *
+         * @param option Option alias (name)
+         * @param verbose Whether to print an error if option was not found
+         * @return Handle. Evaluates to false if option wasn't found
+         * @see find_option()
+         */
+        Handle handle(const std::string_view option, const bool verbose = true);
 
-            return nullptr;
+        /**
+         * Check if option was provided
+         *
+         * @param h Option handle
+         */
+        bool provided(const Handle h) const
+        {
+            const Option* found{resolve(h)};
+            return found && found->provided;
         }
 
         /**
-         * Check if option was provided
+         * Get value for a compound option without copying it
          *
-         * @param option Option name
+         * @param h Option handle
+         * @param index
+         * @see Option::view()
          */
-        bool check(const std::string& option)
+        std::string_view value(const Handle h, const std::size_t index = 0) const
         {
-            error = Error::NoError;
-            Option* found{find_option(option)};
+            const Option* found{resolve(h)};
+            return found ? found->view(index) : std::string_view{};
+        }
 
-            if (!found) {
-                error = Error::OptionDoesntExist;
-                return false;
-            }
+        /**
+         * Get amount of values user provided for a compound option
+         *
+         * @param h Option handle
+         * @see Option::count()
+         */
+        std::size_t count(const Handle h) const
+        {
+            const Option* found{resolve(h)};
+            return found ? found->count() : 0;
+        }
 
-            return found->provided;
+        /**
+         * Get all elements of a compound option without copying them
+         *
+         * @param h Option handle
+         * @see Option::elements()
+         */
+        Elements elements(const Handle h) const
+        {
+            const Option* found{resolve(h)};
+            return found ? found->elements() : Elements{};
         }
 
+        /**
+         * Check if option was provided
+         *
+         * @param option Option name
+         */
+        bool check(const std::string_view option);
+
         /**
          * Get value for the requested compound option
          *
@@ -304,18 +330,15 @@ namespace CLOrca {
          * @param index
          * @see Option::Type
          */
-        std::string get(const std::string& option, const int index = 0)
-        {
-            error = Error::NoError;
-            Option* found{find_option(option)};
+        std::string get(const std::string_view option, const int index = 0);
 
-            if (!found) {
-                error = Error::OptionDoesntExist;
-                return "";
-            }
-
-            return found->get(index);
-        }
+        /**
+         * Get all elements of the requested compound option without copying them
+         *
+         * @param option Option name
+         * @see Option::elements()
+         */
+        Elements get_elements(const std::string_view option);
 
         /**
          * Get an auto-generated help page. To do so it uses Option's description, name
@@ -326,29 +349,7 @@ namespace CLOrca {
          *                      are main arguments.
          * @see Option
          */
-        std::string get_help(const std::vector<std::string>& possible_args)
-        {
-            std::string result{"Usage:\n\t" + executable_name};
-            std::string usage, str_options;
-
-            for (const Option& o : options) {
-                usage += " [" + o.aliases.at(0);
-
-                if (o.is_compound() && o.name.size())
-                    usage += "[=]" + o.name;
-
-                usage += "]";
-                str_options += "\t" + o.get_aliases() + "\n\t\t" + o.description + "\n";
-            }
-
-            for (const std::string& arg : possible_args) {
-                usage += " [" + arg + "]";
-            }
-
-            str_options = "\n\nOptions:\n" + str_options;
-
-            return result + usage + str_options;
-        }
+        std::string get_help(const std::vector<std::string>& possible_args);
 
         /**
          * Same as get_help(possible_args) but with a single argument
@@ -356,26 +357,14 @@ namespace CLOrca {
          * @param possible_arg
          * @see get_help()
          */
-        std::string get_help(const std::string& possible_arg = "")
-        {
-            std::vector<std::string> possible_args{possible_arg};
-            return get_help(possible_args);
-        }
+        std::string get_help(const std::string& possible_arg = "");
 
         /**
          * Get an argument
          *
          * @param argument_number
          */
-        std::string get_argument(const int argument_number = 0)
-        {
-            if (argument_number < arguments.size())
-                return arguments.at(argument_number);
-            if (argument_number < default_arguments.size())
-                return default_arguments.at(argument_number);
-
-            return "";
-        }
+        std::string get_argument(const int argument_number = 0);
 
         /**
          * Get all arguments
@@ -385,6 +374,33 @@ namespace CLOrca {
             return arguments;
         }
 
+        /**
+         * Get result of a path check for a compound option value
+         *
+         * @param h Option handle
+         * @param index
+         * @see Option::path_status()
+         */
+        PathStatus path_status(const Handle h, const std::size_t index = 0) const
+        {
+            const Option* found{resolve(h)};
+            return found ? found->path_status(index) : PathStatus::Unchecked;
+        }
+
+        /**
+         * Get result of a path check for an argument
+         *
+         * @param argument_number
+         * @see Config::argument_paths
+         */
+        PathStatus argument_status(const std::size_t argument_number = 0) const
+        {
+            if (argument_statuses.size() > argument_number)
+                return argument_statuses[argument_number];
+
+            return PathStatus::Unchecked;
+        }
+
         /**
          * Get the most recent error
          */
@@ -394,3 +410,7 @@ namespace CLOrca {
         }
     };
 };
+
+#ifndef CLORCA_COMPILED
+    #include"CLOrca.ipp"
+#endif
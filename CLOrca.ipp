@@ -0,0 +1,448 @@
+/**
+ *  This file is part of CLOrca.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include<algorithm>
+#include<cerrno>
+#include<sys/stat.h>
+#include"CLOrca.h"
+
+#ifdef _WIN32
+    #include<io.h>
+#else
+    #include<unistd.h>
+#endif
+
+#if CLORCA_DIAGNOSTICS == CLORCA_DIAGNOSTICS_IOSTREAM
+    #include<iostream>
+#endif
+
+#ifdef CLORCA_THREADS
+    #include<atomic>
+    #include<thread>
+    #include<system_error>
+#endif
+
+namespace CLOrca {
+    CLORCA_INLINE void CLOrca::print_error(const std::initializer_list<std::string_view> message) const
+    {
+    #if CLORCA_DIAGNOSTICS == CLORCA_DIAGNOSTICS_NONE
+        (void)message;
+    #else
+        if (!config.verbose)
+            return;
+
+        #if CLORCA_DIAGNOSTICS == CLORCA_DIAGNOSTICS_IOSTREAM
+            std::cerr << config.error_prefix;
+
+            for (const std::string_view part : message)
+                std::cerr << part;
+
+            std::cerr << "\n";
+        #else
+            std::string line{config.error_prefix};
+
+            for (const std::string_view part : message)
+                line += part;
+
+            #if CLORCA_DIAGNOSTICS == CLORCA_DIAGNOSTICS_FD
+                // One write per message, so lines of concurrent processes don't interleave
+                line += '\n';
+                #ifdef _WIN32
+                    (void)_write(2, line.data(), static_cast<unsigned int>(line.size()));
+                #else
+                    (void)::write(STDERR_FILENO, line.data(), line.size());
+                #endif
+            #else
+                diagnostic(line);
+            #endif
+        #endif
+    #endif
+    }
+
+    CLORCA_INLINE OptionInfo CLOrca::get_option_info(const std::string& option)
+    {
+        const std::size_t separator{option.find(SEPARATOR)};
+
+        if (separator == std::string::npos)
+            return {option, "", false};
+
+        return {option.substr(0, separator), option.substr(separator + 1), true};
+    }
+
+    CLORCA_INLINE void CLOrca::load_simple_options(const std::string& option)
+    {
+        for (int i{}; i < option.size(); ++i) {
+            // Skipping "-"
+            if (!i)
+                continue;
+
+            if (option.size() > i + 1 && option.at(i + 1) == SEPARATOR) {
+                load_option("-" + option.substr(i));
+                break;
+            }
+            else
+                load_option("-" + std::string(1, option.at(i)));
+        }
+    }
+
+    CLORCA_INLINE void CLOrca::load_option(const std::string& raw_option)
+    {
+        OptionInfo info{get_option_info(raw_option)};
+        Option* cli_option{find_option(info.option)};
+
+        if (!cli_option) {
+            error = Error::NotPossibleOption;
+            return;
+        }
+
+        cli_option->provided = true;
+
+        if (waiting_value_option) {
+            error = Error::MissingValue;
+            print_error({"Got another option while previous option \"",
+                         waiting_value_option->aliases.at(0), "\" is waiting for a value"});
+            waiting_value_option = nullptr;
+        }
+
+        if (cli_option->is_compound()) {
+            if (info.has_separator) {
+                if (info.value.size())
+                    cli_option->add_value(std::move(info.value));
+                else {
+                    error = Error::MissingValue;
+
+                    if (reporting())
+                        print_error({"Expecting a value for the option \"", info.option,
+                                     "\" after \"", std::string(1, SEPARATOR), "\""});
+                }
+            } else
+                waiting_value_option = cli_option;
+        }
+        else if (info.has_separator) {
+            error = Error::OptionCantHoldValue;
+            print_error({"Option \"", info.option, "\" is not compound and can't hold a value"});
+        }
+    }
+
+    CLORCA_INLINE bool CLOrca::load_options(const int argc, const char** argv)
+    {
+        for (int i{}; i < argc; ++i) {
+            const std::string curr_arg{argv[i]};
+
+            if (i == 0) {
+                executable_name = curr_arg.substr(curr_arg.find_last_of(PATH_SEPARATORS) + 1);
+                continue;
+            }
+
+            // If current argument is an option
+            if (curr_arg.at(0) == '-') {
+                if (curr_arg.size() > 1 && curr_arg.at(1) == '-')
+                    load_option(curr_arg);
+                else
+                    load_simple_options(curr_arg);
+            }
+            // If current argument is not an option, then will check
+            // if any option is waiting for a value
+            else if (waiting_value_option) {
+                waiting_value_option->add_value(curr_arg);
+                waiting_value_option = nullptr;
+            }
+            // If no option is waiting for a value, then just append
+            // current argument to arguments
+            else
+                arguments.push_back(curr_arg);
+        }
+
+        if (waiting_value_option) {
+            error = Error::MissingValue;
+            print_error({"Missing value for option \"", waiting_value_option->aliases.at(0), "\""});
+        }
+
+        for (Option& o : options) {
+            if (o.is_delimited())
+                o.arrange_elements();
+        }
+
+        validate_paths();
+
+        if (
+            config.arguments_limit != ::CLOrca::unlimited_arguments
+            && arguments.size() > config.arguments_limit
+        ) {
+            error = Error::TooMuchArguments;
+
+            if (reporting())
+                print_error({"Unexpected amount of arguments: ",
+                             std::to_string(arguments.size()),
+                             ". Maximum expected amount is: ",
+                             std::to_string(config.arguments_limit)});
+        }
+
+        return error;
+    }
+
+    CLORCA_INLINE PathStatus CLOrca::check_path(
+        std::string& buffer,
+        const std::string_view path,
+        const PathCheck& check
+    )
+    {
+        buffer.assign(path);
+
+    #ifdef _WIN32
+        struct _stat64 info;
+
+        // A path that can't be reached is only unreadable if it has to be readable
+        if (_stat64(buffer.c_str(), &info))
+            return check.readable && errno == EACCES ? PathStatus::NotReadable : PathStatus::Missing;
+        if (check.directory && !(info.st_mode & _S_IFDIR))
+            return PathStatus::NotDirectory;
+        if (check.readable && _access(buffer.c_str(), 4))
+            return PathStatus::NotReadable;
+    #else
+        struct stat info;
+
+        // A path that can't be reached is only unreadable if it has to be readable
+        if (::stat(buffer.c_str(), &info))
+            return check.readable && errno == EACCES ? PathStatus::NotReadable : PathStatus::Missing;
+        if (check.directory && !S_ISDIR(info.st_mode))
+            return PathStatus::NotDirectory;
+        if (check.readable && ::access(buffer.c_str(), R_OK))
+            return PathStatus::NotReadable;
+    #endif
+
+        return PathStatus::Ok;
+    }
+
+    CLORCA_INLINE void CLOrca::validate_paths()
+    {
+        struct PathJob {
+            std::string_view path;
+            const PathCheck* check;
+            PathStatus* status;
+        };
+
+        std::vector<PathJob> jobs;
+
+        for (Option& o : options) {
+            if (!o.is_compound() || !o.path_check.any())
+                continue;
+
+            // Every value view() can return, defaults included
+            const std::size_t checked{std::max(o.count(), o.default_elements().size())};
+            o.path_statuses.assign(checked, PathStatus::Unchecked);
+
+            for (std::size_t i{}; i < checked; ++i)
+                jobs.push_back({o.view(i), &o.path_check, &o.path_statuses[i]});
+        }
+
+        if (config.argument_paths.any()) {
+            argument_statuses.assign(arguments.size(), PathStatus::Unchecked);
+
+            for (std::size_t i{}; i < arguments.size(); ++i)
+                jobs.push_back({arguments[i], &config.argument_paths, &argument_statuses[i]});
+        }
+
+        if (jobs.empty())
+            return;
+
+    #ifdef CLORCA_THREADS
+        constexpr std::size_t batch_size{64};
+        std::atomic<std::size_t> next_batch{};
+
+        auto work{[&jobs, &next_batch] {
+            std::string buffer;
+
+            for (std::size_t begin; (begin = next_batch.fetch_add(batch_size)) < jobs.size();) {
+                const std::size_t end{std::min(begin + batch_size, jobs.size())};
+
+                for (std::size_t i{begin}; i < end; ++i)
+                    *jobs[i].status = check_path(buffer, jobs[i].path, *jobs[i].check);
+            }
+        }};
+
+        std::size_t threads{config.path_check_threads};
+
+        if (!threads)
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        threads = std::min(threads, (jobs.size() + batch_size - 1) / batch_size);
+
+        // The current thread checks paths too
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+
+        for (std::size_t i{1}; i < threads; ++i) {
+            try {
+                pool.emplace_back(work);
+            } catch (const std::system_error&) {
+                break;
+            }
+        }
+
+        work();
+
+        for (std::thread& t : pool)
+            t.join();
+    #else
+        std::string buffer;
+
+        for (const PathJob& job : jobs)
+            *job.status = check_path(buffer, job.path, *job.check);
+    #endif
+
+        for (const PathJob& job : jobs) {
+            if (!job.check->failed(*job.status))
+                continue;
+
+            error = Error::InvalidPath;
+
+            switch (*job.status) {
+                case PathStatus::Missing:
+                    print_error({"Path \"", job.path, "\" doesn't exist"});
+                    break;
+                case PathStatus::NotDirectory:
+                    print_error({"Path \"", job.path, "\" is not a directory"});
+                    break;
+                case PathStatus::NotReadable:
+                    print_error({"Path \"", job.path, "\" is not readable"});
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    CLORCA_INLINE CLOrca::CLOrca(
+        const int argc,
+        const char** argv,
+        const std::vector<Option>& options,
+        const std::vector<std::string> default_arguments,
+        const Config& config
+    ): options(options), config(config), default_arguments(default_arguments)
+    {
+        load_options(argc, argv);
+    }
+
+    CLORCA_INLINE Option* CLOrca::find_option(const std::string_view option, const bool verbose)
+    {
+        auto f{std::find_if(options.begin(), options.end(), [option] (const Option& o) {
+            return o.has_alias(option);
+        })};
+
+        if (f != options.end())
+            return &(*f);
+
+        if (verbose)
+            print_error({"Option \"", option, "\" isn't a possible option"});
+
+        return nullptr;
+    }
+
+    CLORCA_INLINE Handle CLOrca::handle(const std::string_view option, const bool verbose)
+    {
+        Option* found{find_option(option, verbose)};
+
+        if (!found)
+            return {};
+
+        return Handle(found - options.data());
+    }
+
+    CLORCA_INLINE bool CLOrca::check(const std::string_view option)
+    {
+        error = Error::NoError;
+        const Handle h{handle(option)};
+
+        if (!h) {
+            error = Error::OptionDoesntExist;
+            return false;
+        }
+
+        return provided(h);
+    }
+
+    CLORCA_INLINE std::string CLOrca::get(const std::string_view option, const int index)
+    {
+        error = Error::NoError;
+        const Handle h{handle(option)};
+
+        if (!h) {
+            error = Error::OptionDoesntExist;
+            return "";
+        }
+        if (index < 0)
+            return "";
+
+        return std::string(value(h, static_cast<std::size_t>(index)));
+    }
+
+    CLORCA_INLINE Elements CLOrca::get_elements(const std::string_view option)
+    {
+        error = Error::NoError;
+        const Handle h{handle(option)};
+
+        if (!h) {
+            error = Error::OptionDoesntExist;
+            return {};
+        }
+
+        return elements(h);
+    }
+
+    CLORCA_INLINE std::string CLOrca::get_help(const std::vector<std::string>& possible_args)
+    {
+        std::string result{"Usage:\n\t" + executable_name};
+        std::string usage, str_options;
+
+        for (const Option& o : options) {
+            usage += " [" + o.aliases.at(0);
+
+            if (o.is_compound() && o.name.size())
+                usage += "[=]" + o.name;
+
+            usage += "]";
+            str_options += "\t" + o.get_aliases() + "\n\t\t" + o.description + "\n";
+        }
+
+        for (const std::string& arg : possible_args) {
+            usage += " [" + arg + "]";
+        }
+
+        str_options = "\n\nOptions:\n" + str_options;
+
+        return result + usage + str_options;
+    }
+
+    CLORCA_INLINE std::string CLOrca::get_help(const std::string& possible_arg)
+    {
+        std::vector<std::string> possible_args{possible_arg};
+        return get_help(possible_args);
+    }
+
+    CLORCA_INLINE std::string CLOrca::get_argument(const int argument_number)
+    {
+        if (argument_number < arguments.size())
+            return arguments.at(argument_number);
+        if (argument_number < default_arguments.size())
+            return default_arguments.at(argument_number);
+
+        return "";
+    }
+};
@@ -19,9 +19,183 @@
 
 #include<vector>
 #include<string>
-#include<algorithm>
+#include<string_view>
+#include<cstddef>
+#include<iterator>
+
+/**
+ * Define CLORCA_COMPILED and link against the clorca library to keep
+ * definitions out of every translation unit that includes CLOrca.
+ * Otherwise CLOrca stays header-only.
+ */
+#ifndef CLORCA_INLINE
+    #ifdef CLORCA_COMPILED
+        #define CLORCA_INLINE
+    #else
+        #define CLORCA_INLINE inline
+    #endif
+#endif
 
 namespace CLOrca {
+    /**
+     * Delimiter settings for options that hold several values in one
+     * argument. e.g. "-I a,b,c" or "--hosts=h1:h2:h3"
+     */
+    struct Delimiter {
+        /** @var Symbol that separates values. '\0' means the value is not split */
+        unsigned char symbol{};
+        /** @var Whether to drop repeated elements, keeping the first occurrence */
+        bool unique{};
+        /** @var Whether to sort elements lexicographically */
+        bool sorted{};
+    };
+
+    /**
+     * Result of a path check
+     */
+    enum class PathStatus : unsigned char {
+        Unchecked,
+        Ok,
+        Missing,
+        NotDirectory,
+        NotReadable,
+    };
+
+    /**
+     * Requirements for options and arguments that hold paths. Paths are
+     * checked right after parsing.
+     *
+     * @see CLOrca::validate_paths()
+     */
+    struct PathCheck {
+        /**
+         * @var Path has to exist. If not set, a missing path gets
+         *      PathStatus::Missing but isn't an error, while an existing one
+         *      still has to pass the other checks. e.g. {false, true} - an
+         *      optional directory that has to be a directory if it exists.
+         */
+        bool exists{};
+        /** @var Path has to be a directory */
+        bool directory{};
+        /** @var Path has to be readable by the current user */
+        bool readable{};
+
+        /**
+         * Whether a path with the status failed this check
+         *
+         * @param status
+         */
+        bool failed(const PathStatus status) const
+        {
+            return status != PathStatus::Ok && (status != PathStatus::Missing || exists);
+        }
+
+        /**
+         * Whether any requirement is set
+         */
+        bool any() const
+        {
+            return exists || directory || readable;
+        }
+    };
+
+    /**
+     * Position of a single element inside Option::values
+     */
+    struct Span {
+        std::size_t value{};
+        std::size_t offset{};
+        std::size_t length{};
+    };
+
+    /**
+     * Read-only range of option elements. Doesn't own or copy anything,
+     * so every element is just a view into the strings of an option.
+     *
+     * @see Option::elements()
+     */
+    class Elements {
+        const std::vector<std::string>* source{};
+        /** @var nullptr means every string of the source is an element by itself */
+        const std::vector<Span>* spans{};
+
+    public:
+        class iterator {
+            const std::vector<std::string>* source{};
+            const std::vector<Span>* spans{};
+            std::size_t index{};
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::string_view;
+
+            iterator() = default;
+            iterator(const Elements& range, const std::size_t index)
+                : source(range.source), spans(range.spans), index(index)
+            {
+            }
+
+            std::string_view operator*() const { return Elements(source, spans)[index]; }
+            std::string_view operator[](const difference_type n) const { return Elements(source, spans)[index + n]; }
+            iterator& operator++() { ++index; return *this; }
+            iterator operator++(int) { iterator copy{*this}; ++index; return copy; }
+            iterator& operator--() { --index; return *this; }
+            iterator operator--(int) { iterator copy{*this}; --index; return copy; }
+            iterator& operator+=(const difference_type n) { index += n; return *this; }
+            iterator& operator-=(const difference_type n) { index -= n; return *this; }
+            iterator operator+(const difference_type n) const { iterator copy{*this}; return copy += n; }
+            iterator operator-(const difference_type n) const { iterator copy{*this}; return copy -= n; }
+            difference_type operator-(const iterator& other) const { return index - other.index; }
+            bool operator==(const iterator& other) const { return index == other.index; }
+            bool operator!=(const iterator& other) const { return index != other.index; }
+            bool operator<(const iterator& other) const { return index < other.index; }
+            bool operator>(const iterator& other) const { return index > other.index; }
+            bool operator<=(const iterator& other) const { return index <= other.index; }
+            bool operator>=(const iterator& other) const { return index >= other.index; }
+
+            friend iterator operator+(const difference_type n, const iterator& it) { return it + n; }
+        };
+
+        Elements() = default;
+        Elements(const std::vector<std::string>* source, const std::vector<Span>* spans = nullptr)
+            : source(source), spans(spans)
+        {
+        }
+
+        std::size_t size() const
+        {
+            if (!source)
+                return 0;
+
+            return spans ? spans->size() : source->size();
+        }
+
+        bool empty() const
+        {
+            return !size();
+        }
+
+        /**
+         * Get an element. No bounds checking is done
+         *
+         * @param index
+         */
+        std::string_view operator[](const std::size_t index) const
+        {
+            if (!spans)
+                return (*source)[index];
+
+            const Span& span{(*spans)[index]};
+            return std::string_view((*source)[span.value]).substr(span.offset, span.length);
+        }
+
+        iterator begin() const { return {*this, 0}; }
+        iterator end() const { return {*this, size()}; }
+    };
+
     class Option {
     public:
         /**
@@ -37,6 +211,19 @@ namespace CLOrca {
         const std::string name;
         std::vector<std::string> values;
 
+        /** @var Positions of split elements in values. Used only with a delimiter */
+        std::vector<Span> spans;
+
+        /**
+         * @var Positions of split elements in defaults. Used only with a delimiter.
+         *      Filled by the constructor, so split_defaults() has to be called
+         *      again if defaults are changed afterwards.
+         */
+        std::vector<Span> default_spans;
+
+        /** @var Results of path checks, one for each index view() has a value for */
+        std::vector<PathStatus> path_statuses;
+
         /**
          * @var Default option values. Be aware that even though you can pass
          *      default values for a simple option, they won't be used for
@@ -46,6 +233,8 @@ namespace CLOrca {
          */
         std::vector<std::string> defaults;
         const Type type;
+        const Delimiter delimiter;
+        const PathCheck path_check;
 
         /** @var Whether an option was provided by user */
         bool provided{};
@@ -58,16 +247,24 @@ namespace CLOrca {
          *                                 Simple options can't hold a value e.g. "-h"
          * @param name Option name. Used in generation of auto-help. {@see CLOrca::get_help()}
          * @param description Description. Used in generation of auto-help.
-         * @param defaults Default values for an option
+         * @param defaults Default values for an option. For a delimited option
+         *                 they are split the same way as values provided by user.
+         * @param delimiter Split every value of a compound option by delimiter.symbol
+         *                  e.g. "-I a,b,c" with {','} holds "a", "b" and "c"
+         * @param path_check Requirements for values that are paths. e.g. {true} - path must exist
          */
        Option(
             const std::vector<std::string> aliases,
             const Type type,
             const std::string& name = "",
             const std::string& description = "",
-            const std::vector<std::string>& defaults = {}
-        ): type(type), aliases(aliases), description(description), name(name), defaults(defaults)
+            const std::vector<std::string>& defaults = {},
+            const Delimiter& delimiter = {},
+            const PathCheck& path_check = {}
+        ): type(type), delimiter(delimiter), path_check(path_check), aliases(aliases), description(description), name(name), defaults(defaults)
         {
+            if (is_delimited())
+                split_defaults();
         }
 
         /**
@@ -81,9 +278,13 @@ namespace CLOrca {
             const Type type,
             const std::string& name,
             const std::string& description,
-            const T& defaults
-        ): type(type), aliases(aliases), description(description), name(name), defaults({defaults})
+            const T& defaults,
+            const Delimiter& delimiter = {},
+            const PathCheck& path_check = {}
+        ): type(type), delimiter(delimiter), path_check(path_check), aliases(aliases), description(description), name(name), defaults({defaults})
         {
+            if (is_delimited())
+                split_defaults();
         }
 
         /**
@@ -91,14 +292,7 @@ namespace CLOrca {
          *
          * @param alias Alias name
          */
-        bool has_alias(const std::string& alias) const
-        {
-            auto f{std::find_if(aliases.begin(), aliases.end(), [&alias] (const std::string& a) {
-                return alias == a;
-            })};
-
-            return f != aliases.end();
-        }
+        bool has_alias(const std::string_view alias) const;
 
         /**
          * Whether an option is compound
@@ -109,42 +303,157 @@ namespace CLOrca {
         }
 
         /**
-         * Get value for a compound option
+         * Whether values of an option are split by a delimiter
+         */
+        bool is_delimited() const
+        {
+            return delimiter.symbol;
+        }
+
+        /**
+         * Store a value provided by user. If an option is delimited, the
+         * value is split right away and only positions of its elements are
+         * stored, so no extra strings are created. Empty elements are skipped.
          *
-         * @param index Value index. e.g. if "./foo -f bar.txt -f test.txt", then
-         *              get() will return bar.txt, get(1) will return test.txt
+         * @param value
          */
-        std::string get(const int index = 0) const
+        void add_value(std::string value);
+
+        /**
+         * Split every default by the delimiter and apply Delimiter::sorted and
+         * Delimiter::unique to them
+         */
+        void split_defaults();
+
+        /**
+         * Apply Delimiter::sorted and Delimiter::unique to split elements.
+         * Called once all the values are loaded.
+         */
+        void arrange_elements();
+
+        /**
+         * Get elements provided by user. For a delimited option these are
+         * the split parts of every value, otherwise values themselves.
+         */
+        Elements provided_elements() const
+        {
+            if (!is_compound())
+                return {};
+
+            return {&values, is_delimited() ? &spans : nullptr};
+        }
+
+        /**
+         * Get default elements. For a delimited option these are split
+         * parts of every default.
+         */
+        Elements default_elements() const
         {
             if (!is_compound())
-                return "";
+                return {};
 
-            if (values.size() > index)
-                return values.at(index);
-            if (defaults.size() > index)
-                return defaults.at(index);
+            return {&defaults, is_delimited() ? &default_spans : nullptr};
+        }
 
-            return "";
+        /**
+         * Get all elements of a compound option without copying them: elements
+         * provided by user, or default elements if user provided none.
+         * Elements stay valid as long as the option isn't modified.
+         */
+        Elements elements() const
+        {
+            const Elements provided{provided_elements()};
+            return provided.size() ? provided : default_elements();
         }
 
         /**
-         * Get all aliases as a string separated by {@param unifying_str}
+         * Get value for a compound option without copying it. The view stays
+         * valid as long as the option isn't modified.
          *
-         * @param unifying_str
+         * @param index Element index. e.g. if "./foo -f bar.txt -f test.txt", then
+         *              view() will return bar.txt, view(1) will return test.txt.
+         *              For a delimited option it's an index of a split element.
+         *              If user provided fewer elements than index, a default
+         *              element with the same index is returned. So with no
+         *              elements provided view(i) == elements()[i].
          */
-        std::string get_aliases(const std::string& unifying_str = ", ") const
+        std::string_view view(const std::size_t index = 0) const
         {
-            std::string result;
+            const Elements provided{provided_elements()};
 
-            for (const std::string& alias : aliases) {
-                if (result.size()) {
-                    result += unifying_str;
-                }
+            if (provided.size() > index)
+                return provided[index];
 
-                result += alias;
-            }
+            const Elements fallback{default_elements()};
+
+            if (fallback.size() > index)
+                return fallback[index];
 
-            return result;
+            return {};
         }
+
+        /**
+         * Get value for a compound option
+         *
+         * @param index Value index. Negative index gives an empty string
+         * @see view()
+         */
+        std::string get(const int index = 0) const
+        {
+            return index < 0 ? std::string{} : std::string(view(static_cast<std::size_t>(index)));
+        }
+
+        /**
+         * Get amount of values provided by user. For a delimited option it's
+         * an amount of split elements. Defaults aren't counted.
+         */
+        std::size_t count() const
+        {
+            return provided_elements().size();
+        }
+
+        /**
+         * Get result of a path check for a value. Defaults are checked too,
+         * so it's the result for exactly the value view(index) returns.
+         *
+         * @param index Value index, same as in view()
+         * @return PathStatus::Unchecked if option has no PathCheck or there's no such value
+         */
+        PathStatus path_status(const std::size_t index = 0) const
+        {
+            if (path_statuses.size() > index)
+                return path_statuses[index];
+
+            return PathStatus::Unchecked;
+        }
+
+        /**
+         * Get all aliases as a string separated by {@param unifying_str}
+         *
+         * @param unifying_str
+         */
+        std::string get_aliases(const std::string& unifying_str = ", ") const;
+
+    protected:
+        /**
+         * Append positions of non-empty parts of a value split by the delimiter
+         *
+         * @param value
+         * @param value_index Index of the value in its vector
+         * @param result
+         */
+        void split(const std::string& value, const std::size_t value_index, std::vector<Span>& result) const;
+
+        /**
+         * Apply Delimiter::sorted and Delimiter::unique to split elements
+         *
+         * @param source Strings elements point into
+         * @param elements
+         */
+        void arrange(const std::vector<std::string>& source, std::vector<Span>& elements) const;
     };
 };
+
+#ifndef CLORCA_COMPILED
+    #include"Option.ipp"
+#endif
@@ -0,0 +1,139 @@
+/**
+ *  This file is part of CLOrca.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include<algorithm>
+#include"Option.h"
+
+namespace CLOrca {
+    CLORCA_INLINE bool Option::has_alias(const std::string_view alias) const
+    {
+        auto f{std::find_if(aliases.begin(), aliases.end(), [&alias] (const std::string& a) {
+            return alias == a;
+        })};
+
+        return f != aliases.end();
+    }
+
+    CLORCA_INLINE void Option::split(
+        const std::string& value,
+        const std::size_t value_index,
+        std::vector<Span>& result
+    ) const
+    {
+        std::size_t start{};
+
+        while (start <= value.size()) {
+            std::size_t end{value.find(delimiter.symbol, start)};
+
+            if (end == std::string::npos)
+                end = value.size();
+            if (end > start)
+                result.push_back({value_index, start, end - start});
+
+            start = end + 1;
+        }
+    }
+
+    CLORCA_INLINE void Option::arrange(const std::vector<std::string>& source, std::vector<Span>& elements) const
+    {
+        if (!delimiter.sorted && !delimiter.unique)
+            return;
+
+        struct Keyed {
+            std::string_view view;
+            std::size_t index;
+        };
+
+        std::vector<Keyed> order(elements.size());
+
+        for (std::size_t i{}; i < elements.size(); ++i) {
+            const Span& s{elements[i]};
+            order[i] = {std::string_view(source[s.value]).substr(s.offset, s.length), i};
+        }
+
+        // Equal elements are ordered by position, so the first occurrence comes first
+        std::sort(order.begin(), order.end(), [] (const Keyed& x, const Keyed& y) {
+            const int compared{x.view.compare(y.view)};
+            return compared < 0 || (!compared && x.index < y.index);
+        });
+
+        std::vector<Span> arranged;
+        arranged.reserve(elements.size());
+
+        if (delimiter.sorted) {
+            for (std::size_t k{}; k < order.size(); ++k) {
+                if (delimiter.unique && k && order[k].view == order[k - 1].view)
+                    continue;
+
+                arranged.push_back(elements[order[k].index]);
+            }
+        }
+        else {
+            std::vector<bool> repeated(elements.size());
+
+            for (std::size_t k{1}; k < order.size(); ++k)
+                repeated[order[k].index] = order[k].view == order[k - 1].view;
+
+            for (std::size_t i{}; i < elements.size(); ++i) {
+                if (!repeated[i])
+                    arranged.push_back(elements[i]);
+            }
+        }
+
+        elements = std::move(arranged);
+    }
+
+    CLORCA_INLINE void Option::add_value(std::string value)
+    {
+        values.push_back(std::move(value));
+
+        if (is_delimited())
+            split(values.back(), values.size() - 1, spans);
+    }
+
+    CLORCA_INLINE void Option::split_defaults()
+    {
+        default_spans.clear();
+
+        for (std::size_t i{}; i < defaults.size(); ++i)
+            split(defaults[i], i, default_spans);
+
+        arrange(defaults, default_spans);
+    }
+
+    CLORCA_INLINE void Option::arrange_elements()
+    {
+        arrange(values, spans);
+    }
+
+    CLORCA_INLINE std::string Option::get_aliases(const std::string& unifying_str) const
+    {
+        std::string result;
+
+        for (const std::string& alias : aliases) {
+            if (result.size()) {
+                result += unifying_str;
+            }
+
+            result += alias;
+        }
+
+        return result;
+    }
+};
@@ -0,0 +1,61 @@
+/**
+ *  This file is part of CLOrca.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Built as a separate executable, since CLORCA_DIAGNOSTICS has to be the
+// same in every file of a program
+#define CLORCA_DIAGNOSTICS CLORCA_DIAGNOSTICS_CALLBACK
+
+#include<catch2/catch_amalgamated.hpp>
+#include"../CLOrca.h"
+
+std::vector<std::string> messages;
+
+void CLOrca::diagnostic(std::string_view message)
+{
+    messages.emplace_back(message);
+}
+
+TEST_CASE("Testing callback diagnostics", "[diagnostics]") {
+    const char* argv[]{
+        "tests",
+        "--doesnt-exist",
+        "argument",
+        "argument2",
+    };
+    std::vector<CLOrca::Option> input_options{
+        {{"-h", "--help"}, CLOrca::Option::Type::Simple, "help", "print help page"},
+    };
+
+    CLOrca::Config config;
+    config.error_prefix = "test: ";
+    config.arguments_limit = 1;
+
+    messages.clear();
+    CLOrca::CLOrca options{4, argv, input_options, {}, config};
+
+    CHECK(options.get_error() == CLOrca::Error::TooMuchArguments);
+    REQUIRE(messages.size() == 2);
+    CHECK(messages.at(0) == "test: Option \"--doesnt-exist\" isn't a possible option");
+    CHECK(messages.at(1) == "test: Unexpected amount of arguments: 2. Maximum expected amount is: 1");
+
+    config.verbose = false;
+    messages.clear();
+    CLOrca::CLOrca quiet_options{4, argv, input_options, {}, config};
+
+    CHECK(quiet_options.get_error() == CLOrca::Error::TooMuchArguments);
+    CHECK(messages.empty());
+}
@@ -17,6 +17,9 @@
 
 #include<catch2/catch_amalgamated.hpp>
 #include"../CLOrca.h"
+#include<filesystem>
+#include<fstream>
+#include<random>
 
 const char* argv[]{
     "tests",
@@ -143,8 +146,299 @@ TEST_CASE("Testing general error cases", "[errors]") {
     CHECK(options_three.get_error() == CLOrca::Error::NotPossibleOption);
 }
 
+TEST_CASE("Testing delimited options", "[delimiter]") {
+    const char* argv1[]{
+        "tests",
+        "-I",
+        "b,a,,c",
+        "--include=a,d",
+        "--hosts=h2:h1:h2",
+        "-s=x;y",
+    };
+
+    CLOrca::CLOrca options{6, argv1, {
+        {{"-I", "--include"}, CLOrca::Option::Type::Compound, "include", "include directories", {}, {','}},
+        {{"--hosts"}, CLOrca::Option::Type::Compound, "hosts", "hosts", {}, {':', true, true}},
+        {{"-s"}, CLOrca::Option::Type::Compound, "sorted", "sorted", {}, {';', false, true}},
+        {{"-u"}, CLOrca::Option::Type::Compound, "unique", "unique", {"1", "2"}, {',', true}},
+    }, {}, {"", false}};
+
+    REQUIRE_FALSE(options.get_error());
+
+    CLOrca::Elements include{options.get_elements("-I")};
+    REQUIRE(include.size() == 5);
+    CHECK(include[0] == "b");
+    CHECK(include[1] == "a");
+    CHECK(include[2] == "c");
+    CHECK(include[3] == "a");
+    CHECK(include[4] == "d");
+    CHECK(options.get("-I", 2) == "c");
+    CHECK(options.get("--include", 4) == "d");
+
+    std::vector<std::string_view> hosts(
+        options.get_elements("--hosts").begin(), options.get_elements("--hosts").end());
+    CHECK(hosts == std::vector<std::string_view>{"h1", "h2"});
+
+    CLOrca::Elements sorted{options.get_elements("-s")};
+    REQUIRE(sorted.size() == 2);
+    CHECK(sorted[0] == "x");
+    CHECK(sorted[1] == "y");
+
+    CLOrca::Elements unique{options.get_elements("-u")};
+    REQUIRE(unique.size() == 2);
+    CHECK(unique[1] == "2");
+
+    CHECK(options.get_elements("--non-existent").empty());
+    CHECK(options.get_error() == CLOrca::Error::OptionDoesntExist);
+}
+
+TEST_CASE("Testing delimited defaults", "[delimiter]") {
+    const char* argv1[]{
+        "tests",
+        "-I",
+        ",,",
+    };
+    std::vector<CLOrca::Option> delimited_options{
+        {{"-I"}, CLOrca::Option::Type::Compound, "include", "include directories", {"def"}, {','}},
+        {{"-x"}, CLOrca::Option::Type::Compound, "x", "x", {"y,x", "x"}, {',', true, true}},
+    };
+    CLOrca::CLOrca options{3, argv1, delimited_options, {}, {"", false}};
+
+    REQUIRE_FALSE(options.get_error());
+
+    CLOrca::Elements include{options.get_elements("-I")};
+    REQUIRE(include.size() == 1);
+    CHECK(include[0] == "def");
+    CHECK(options.get("-I") == "def");
+    CHECK(options.count(options.handle("-I")) == 0);
+
+    CLOrca::Elements x{options.get_elements("-x")};
+    REQUIRE(x.size() == 2);
+    CHECK(x[0] == "x");
+    CHECK(x[1] == "y");
+    CHECK(options.get("-x", 1) == "y");
+
+    std::vector<std::string_view> reversed(std::make_reverse_iterator(x.end()), std::make_reverse_iterator(x.begin()));
+    CHECK(reversed == std::vector<std::string_view>{"y", "x"});
+    CHECK(x.begin() + 2 == 2 + x.begin());
+    CHECK(x.begin() <= x.end());
+}
+
+TEST_CASE("Testing option handles", "[handles]") {
+    CLOrca::CLOrca options{argc, argv, input_options, {}, {"", false}};
+
+    const CLOrca::Handle help{options.handle("--help")};
+    const CLOrca::Handle file{options.handle("-f")};
+    const CLOrca::Handle defaults{options.handle("-d")};
+    const CLOrca::Handle missing{options.handle("--non-existent")};
+
+    REQUIRE(help);
+    REQUIRE(file);
+    REQUIRE_FALSE(missing);
+
+    CHECK(options.provided(help));
+    CHECK_FALSE(options.provided(missing));
+    CHECK(options.value(file) == "filename.txt");
+    CHECK(options.value(file, 1) == "filename2.txt");
+    CHECK(options.value(file, 2).empty());
+    CHECK(options.value(help).empty());
+    CHECK(options.value(defaults, 2) == "default_option3");
+    CHECK(options.value(missing).empty());
+    CHECK(options.get("-f", -1).empty());
+    CHECK(options.count(file) == 2);
+    CHECK(options.count(defaults) == 2);
+    CHECK(options.count(help) == 0);
+    CHECK(options.count(missing) == 0);
+    CHECK(options.elements(file).size() == 2);
+    CHECK(options.elements(file)[1] == "filename2.txt");
+    CHECK(options.elements(missing).empty());
+
+    // Handle of an option that doesn't exist in another object
+    CLOrca::CLOrca options_two{1, argv, {input_options.at(0)}, {}, {"", false}};
+    CHECK_FALSE(options_two.provided(defaults));
+    CHECK(options_two.value(defaults).empty());
+    CHECK(options_two.count(defaults) == 0);
+    CHECK(options_two.elements(defaults).empty());
+}
+
+/**
+ * Get a path in the temp directory that no other test run uses
+ *
+ * @param name
+ */
+std::filesystem::path unique_temp_path(const std::string& name)
+{
+    std::random_device random;
+    return std::filesystem::temp_directory_path() / (name + "_" + std::to_string(random()) + std::to_string(random()));
+}
+
+TEST_CASE("Testing path checks", "[paths]") {
+    const std::filesystem::path dir{unique_temp_path("clorca_tests_paths")};
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "file.txt") << "orca";
+
+    const std::string dir_str{dir.string()};
+    const std::string file_str{(dir / "file.txt").string()};
+    const std::string missing_str{(dir / "missing.txt").string()};
+    const std::string includes{"--include=" + dir_str + "," + file_str};
+    const std::string input{"--input=" + file_str};
+
+    const char* argv1[]{
+        "tests",
+        includes.c_str(),
+        input.c_str(),
+        file_str.c_str(),
+        missing_str.c_str(),
+        dir_str.c_str(),
+    };
+    std::vector<CLOrca::Option> path_options{
+        {{"-I", "--include"}, CLOrca::Option::Type::Compound, "dirs", "include directories", {}, {','}, {true, true}},
+        {{"--input"}, CLOrca::Option::Type::Compound, "input", "input file", {}, {}, {true, false, true}},
+        {{"-f"}, CLOrca::Option::Type::Compound, "file", "not checked"},
+    };
+
+    CLOrca::Config config;
+    config.verbose = false;
+    config.argument_paths = {true};
+    config.path_check_threads = 4;
+    CLOrca::CLOrca options{6, argv1, path_options, {}, config};
+
+    CHECK(options.get_error() == CLOrca::Error::InvalidPath);
+
+    const CLOrca::Handle include{options.handle("-I")};
+    CHECK(options.path_status(include) == CLOrca::PathStatus::Ok);
+    CHECK(options.path_status(include, 1) == CLOrca::PathStatus::NotDirectory);
+    CHECK(options.path_status(include, 2) == CLOrca::PathStatus::Unchecked);
+    CHECK(options.path_status(options.handle("--input")) == CLOrca::PathStatus::Ok);
+    CHECK(options.path_status(options.handle("-f")) == CLOrca::PathStatus::Unchecked);
+    CHECK(options.argument_status() == CLOrca::PathStatus::Ok);
+    CHECK(options.argument_status(1) == CLOrca::PathStatus::Missing);
+    CHECK(options.argument_status(2) == CLOrca::PathStatus::Ok);
+    CHECK(options.argument_status(3) == CLOrca::PathStatus::Unchecked);
+
+    const char* argv2[]{
+        "tests",
+        input.c_str(),
+        file_str.c_str(),
+    };
+    CLOrca::CLOrca options_two{3, argv2, path_options, {}, config};
+    CHECK_FALSE(options_two.get_error());
+
+    // Defaults are checked, and a path that doesn't have to exist only has
+    // to pass other checks when it does
+    CLOrca::CLOrca options_three{1, argv2, {
+        {{"-o"}, CLOrca::Option::Type::Compound, "output", "output directory", {missing_str, file_str}, {}, {false, true}},
+    }, {}, config};
+    const CLOrca::Handle output{options_three.handle("-o")};
+
+    CHECK(options_three.get_error() == CLOrca::Error::InvalidPath);
+    CHECK(options_three.path_status(output) == CLOrca::PathStatus::Missing);
+    CHECK(options_three.path_status(output, 1) == CLOrca::PathStatus::NotDirectory);
+
+    CLOrca::CLOrca options_four{1, argv2, {
+        {{"-o"}, CLOrca::Option::Type::Compound, "output", "output directory", missing_str, {}, {false, true}},
+        {{"-d"}, CLOrca::Option::Type::Compound, "dir", "directory", dir_str, {}, {true, true}},
+    }, {}, config};
+
+    CHECK_FALSE(options_four.get_error());
+    CHECK(options_four.path_status(options_four.handle("-o")) == CLOrca::PathStatus::Missing);
+    CHECK(options_four.path_status(options_four.handle("-d")) == CLOrca::PathStatus::Ok);
+
+    CLOrca::CLOrca options_five{1, argv2, {
+        {{"-i"}, CLOrca::Option::Type::Compound, "input", "input", missing_str, {}, {true}},
+    }, {}, config};
+
+    CHECK(options_five.get_error() == CLOrca::Error::InvalidPath);
+
+    std::filesystem::remove_all(dir);
+}
+
 TEST_CASE("Benchmark", "[!benchmark]") {
     BENCHMARK("CLOrca object initialization benchmark") {
         CLOrca::CLOrca options_bench{argc, argv, input_options};
     };
+
+    CLOrca::CLOrca options_query{argc, argv, input_options};
+    const CLOrca::Handle help{options_query.handle("--help")};
+    const CLOrca::Handle defaults{options_query.handle("-d")};
+
+    BENCHMARK("Querying options by name") {
+        return options_query.check("--help") + options_query.get("-d", 2).size();
+    };
+
+    BENCHMARK("Querying options by handle") {
+        return options_query.provided(help) + options_query.value(defaults, 2).size();
+    };
+
+    std::string big_value{"--hosts="};
+
+    for (int i{}; i < 100000; ++i)
+        big_value += (i ? ":" : "") + std::to_string(i % 50000);
+
+    const char* argv_delimited[]{"tests", big_value.c_str()};
+    std::vector<CLOrca::Option> delimited_options{
+        {{"--hosts"}, CLOrca::Option::Type::Compound, "hosts", "hosts", {}, {':'}},
+    };
+    std::vector<CLOrca::Option> sorted_options{
+        {{"--hosts"}, CLOrca::Option::Type::Compound, "hosts", "hosts", {}, {':', true, true}},
+    };
+
+    BENCHMARK("Splitting a value with 100k elements") {
+        CLOrca::CLOrca options_bench{2, argv_delimited, delimited_options};
+        return options_bench.get_elements("--hosts").size();
+    };
+
+    BENCHMARK("Splitting, sorting and deduplicating a value with 100k elements") {
+        CLOrca::CLOrca options_bench{2, argv_delimited, sorted_options};
+        return options_bench.get_elements("--hosts").size();
+    };
+
+    BENCHMARK("Splitting a value with 100k elements into strings by hand") {
+        CLOrca::CLOrca options_bench{2, argv_delimited, {
+            {{"--hosts"}, CLOrca::Option::Type::Compound, "hosts", "hosts"},
+        }};
+        const std::string joined{options_bench.get("--hosts")};
+        std::vector<std::string> split;
+        std::size_t start{};
+
+        for (std::size_t end; (end = joined.find(':', start)) != std::string::npos; start = end + 1)
+            split.push_back(joined.substr(start, end - start));
+
+        split.push_back(joined.substr(start));
+        return split.size();
+    };
+
+    const std::filesystem::path dir{unique_temp_path("clorca_bench_paths")};
+    std::vector<std::string> paths;
+
+    for (int i{}; i < 20000; ++i) {
+        const std::filesystem::path sub{dir / std::to_string(i % 100)};
+        std::filesystem::create_directories(sub);
+        std::ofstream(sub / std::to_string(i));
+        paths.push_back((sub / std::to_string(i)).string());
+    }
+
+    std::vector<const char*> argv_paths{"tests"};
+
+    for (const std::string& path : paths)
+        argv_paths.push_back(path.c_str());
+
+    CLOrca::Config serial_config;
+    serial_config.argument_paths = {true, false, true};
+    serial_config.path_check_threads = 1;
+
+    CLOrca::Config parallel_config{serial_config};
+    parallel_config.path_check_threads = 0;
+
+    BENCHMARK("Checking 20k paths serially") {
+        CLOrca::CLOrca options_bench{static_cast<int>(argv_paths.size()), argv_paths.data(), {}, {}, serial_config};
+        return options_bench.get_error();
+    };
+
+    BENCHMARK("Checking 20k paths in parallel") {
+        CLOrca::CLOrca options_bench{static_cast<int>(argv_paths.size()), argv_paths.data(), {}, {}, parallel_config};
+        return options_bench.get_error();
+    };
+
+    std::filesystem::remove_all(dir);
 }